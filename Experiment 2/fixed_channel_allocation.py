@@ -1,5 +1,14 @@
 import math
+import os
 import random
+import sys
+
+import numpy as np
+
+# The native engine is built at the repository root (pip install . or
+# python setup.py build_ext --inplace); fall back to that directory.
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir))
+import channel_engine
 
 class FixedChannelAssignment:
     def __init__(self, total_channels, control_channel_percentage):
@@ -10,76 +19,65 @@ class FixedChannelAssignment:
         self.total_channels = total_channels
         self.control_channel_percentage = control_channel_percentage
         
-        # Calculate control and voice channels
-        self.control_channels = math.ceil(self.total_channels * self.control_channel_percentage / 100)
-        self.voice_channels = self.total_channels - self.control_channels
-        
-        print(f"Total Channels: {self.total_channels} | Control: {self.control_channels} ({self.control_channel_percentage}%) | Voice: {self.voice_channels}")
+        print(f"Total Channels: {self.total_channels} | Control: {self.control_channel_percentage}%")
     
     def create_channel_matrices(self, cluster_size):
         print(f"\nCLUSTER SIZE: {cluster_size}")
         print("="*50)
         
-        # Calculate distribution
-        control_per_cell = self.control_channels // cluster_size
-        voice_per_cell = self.voice_channels // cluster_size
-        extra_control = self.control_channels % cluster_size
-        extra_voice = self.voice_channels % cluster_size
-        
-        print(f"Base channels per cell - Control: {control_per_cell}, Voice: {voice_per_cell}")
-        print(f"Extra channels to distribute - Control: {extra_control}, Voice: {extra_voice}")
+        # Same round-robin layout as fixed_channel.c: channel k goes to cell (k-1) % N.
+        # Matrices are NumPy arrays, one row per cell, unused slots are 0.
+        control_matrix, traffic_matrix = channel_engine.fixed_assign(
+            self.total_channels, cluster_size, self.control_channel_percentage / 100)
         
-        # Initialize matrices
-        control_matrix = []
-        traffic_matrix = []
+        # Control and voice counts come from the engine, which guarantees one control channel per cell
+        control_channels = np.count_nonzero(control_matrix)
+        voice_channels = np.count_nonzero(traffic_matrix)
+        print(f"Control: {control_channels} | Voice: {voice_channels}")
         
         print(f"\nCONTROL CHANNEL MATRIX:")
         print("-"*50)
         print("Cell | Count | Channel Numbers")
         
-        for cell in range(cluster_size):
-            cell_control = control_per_cell + (1 if cell < extra_control else 0)
-            cell_voice = voice_per_cell + (1 if cell < extra_voice else 0)
-            
-            # Create control channels
-            control_start = 1 + (cell * control_per_cell) + min(cell, extra_control)
-            control_channels = list(range(control_start, control_start + cell_control))
-            control_matrix.append(control_channels)
-            
-            print(f"  {cell+1}  |   {cell_control}   | {control_channels}")
+        for cell, row in enumerate(control_matrix):
+            cell_control = row[row > 0].tolist()
+            print(f"  {cell+1}  |   {len(cell_control)}   | {cell_control}")
             
         print(f"\nTRAFFIC CHANNEL MATRIX:")
         print("-"*50)
         print("Cell | Count | Channel Numbers")
         
-        for cell in range(cluster_size):
-            cell_voice = voice_per_cell + (1 if cell < extra_voice else 0)
+        for cell, row in enumerate(traffic_matrix):
+            traffic_channels = row[row > 0].tolist()
             
-            # Create traffic channels
-            traffic_start = self.control_channels + 1 + (cell * voice_per_cell) + min(cell, extra_voice)
-            traffic_channels = list(range(traffic_start, traffic_start + cell_voice))
-            traffic_matrix.append(traffic_channels)
-            
-            # Display with truncation for long lists
+            # Display with truncation for long lists; channels are round-robin,
+            # so show the first few to make the stride visible
             if len(traffic_channels) > 6:
-                display_channels = f"[{traffic_channels[0]}...{traffic_channels[-1]}]"
+                display_channels = f"[{', '.join(map(str, traffic_channels[:3]))}, ..., {traffic_channels[-1]}]"
             else:
                 display_channels = str(traffic_channels)
             
-            print(f"  {cell+1}  |  {cell_voice:2d}   | {display_channels}")
+            print(f"  {cell+1}  |  {len(traffic_channels):2d}   | {display_channels}")
         
         return control_matrix, traffic_matrix
     
     def verify_matrices(self, control_matrix, traffic_matrix):
-        total_control = sum(len(row) for row in control_matrix)
-        total_traffic = sum(len(row) for row in traffic_matrix)
+        control = control_matrix[control_matrix > 0]
+        traffic = traffic_matrix[traffic_matrix > 0]
+        total_control = control.size
+        total_traffic = traffic.size
+        
+        # Control channels must be 1..C and traffic channels C+1..total, each used exactly once
+        assigned = np.sort(np.concatenate((control, traffic)))
+        valid = (np.array_equal(assigned, np.arange(1, self.total_channels + 1))
+                 and control.max() == total_control)
         
         print(f"\nMATRIX VERIFICATION:")
-        print(f"Control channels distributed: {total_control}/{self.control_channels} ✓")
-        print(f"Traffic channels distributed: {total_traffic}/{self.voice_channels} ✓")
-        print(f"Total channels: {total_control + total_traffic}/{self.total_channels} ✓")
+        print(f"Control channels distributed: {total_control} {'✓' if valid else '✗'}")
+        print(f"Traffic channels distributed: {total_traffic} {'✓' if valid else '✗'}")
+        print(f"Total channels: {total_control + total_traffic}/{self.total_channels} {'✓' if valid else '✗'}")
         
-        return total_control == self.control_channels and total_traffic == self.voice_channels
+        return valid
     
     def analyze_frequency_reuse(self, cluster_size):
         frequency_reuse_factor = 1 / cluster_size
@@ -96,8 +94,9 @@ class FixedChannelAssignment:
         
         for i in range(num_calls):
             cell = random.randint(0, cluster_size - 1)
-            if len(traffic_matrix[cell]) > 0:
-                channel = random.choice(traffic_matrix[cell])
+            cell_channels = traffic_matrix[cell][traffic_matrix[cell] > 0]
+            if cell_channels.size > 0:
+                channel = random.choice(cell_channels.tolist())
                 successful += 1
                 if i < 5:  # Show first 5 calls only
                     print(f"Call {i+1}: Cell {cell+1} -> Channel {channel} ✓")
@@ -0,0 +1,174 @@
+#ifndef CHANNEL_ENGINE_H
+#define CHANNEL_ENGINE_H
+
+/*
+ * Channel assignment engine shared by fixed_channel.c, dynamic_channel.c
+ * and the Python extension (channelmodule.c).
+ *
+ * All matrices are flat, row-major buffers of clusterSize rows; row i holds
+ * the channels of cell i + 1 and unused slots are left as 0. Offsets into
+ * them are computed in size_t so large matrices cannot overflow int.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+typedef struct {
+    int channelId;
+    int priority;
+} ChannelInfo;
+
+/**
+ * @brief Checks that N = i^2 + j^2 + i*j for some non-negative i, j.
+ */
+static inline int isValidClusterSize(int N) {
+    if (N <= 0) return 0;
+
+    for (int i = 0; i * i <= N; i++) {
+        for (int j = 0; j * j <= N; j++) {
+            if (i * i + j * j + i * j == N) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Number of control channels used by fixed assignment.
+ * * Takes ceil(totalChannels * percentage), with at least one per cell.
+ */
+static inline int fixedControlChannelCount(int totalChannels, int clusterSize, double controlChannelPercentage) {
+    int controlChannelsCount = (int)ceil(totalChannels * controlChannelPercentage);
+    if (controlChannelsCount < clusterSize) {
+        controlChannelsCount = clusterSize;
+    }
+    return controlChannelsCount;
+}
+
+/**
+ * @brief Number of matrix columns needed to hold count channels over clusterSize cells.
+ */
+static inline int channelMatrixCols(int count, int clusterSize) {
+    return count / clusterSize + (count % clusterSize != 0);
+}
+
+/**
+ * @brief Distributes count consecutive channels round-robin across cells.
+ * * Channel firstChannel + i goes to row i % clusterSize, column i / clusterSize.
+ * @param matrix Zeroed buffer of clusterSize * cols ints.
+ */
+static inline void fixedAssignChannels(int firstChannel, int count, int clusterSize, int* matrix, int cols) {
+    for (int i = 0; i < count; i++) {
+        int row = i % clusterSize;
+        int col = i / clusterSize;
+        if (col < cols) {
+            matrix[(size_t)row * cols + col] = firstChannel + i;
+        }
+    }
+}
+
+/**
+ * @brief Splits control channels into contiguous blocks, one block per cell.
+ * * The first controlChannels % clusterSize cells get one extra channel.
+ * @param matrix Zeroed buffer of clusterSize * cols ints.
+ */
+static inline void dynamicControlLayout(int clusterSize, int controlChannels, int* matrix, int cols) {
+    int baseChannelsPerCell = controlChannels / clusterSize;
+    int extraChannels = controlChannels % clusterSize;
+    int channelId = 1;
+
+    for (int i = 0; i < clusterSize; i++) {
+        int channelsForCell = baseChannelsPerCell + (i < extraChannels ? 1 : 0);
+        for (int j = 0; j < channelsForCell && j < cols; j++) {
+            matrix[(size_t)i * cols + j] = channelId++;
+        }
+    }
+}
+
+/**
+ * @brief Returns the next value in [0, 32767] from the caller's generator state.
+ * * Uses the portable LCG from the C standard, so a given seed produces the
+ * same sequence on every platform and never touches the global rand() stream.
+ */
+static inline int channelRand(unsigned int* rngState) {
+    *rngState = *rngState * 1103515245u + 12345u;
+    return (int)((*rngState / 65536u) % 32768u);
+}
+
+/**
+ * @brief Fisher-Yates shuffle of the channel IDs in channels[0..size).
+ */
+static inline void shuffleChannels(ChannelInfo* channels, int size, unsigned int* rngState) {
+    for (int i = size - 1; i > 0; i--) {
+        int j = channelRand(rngState) % (i + 1);
+        int temp = channels[i].channelId;
+        channels[i].channelId = channels[j].channelId;
+        channels[j].channelId = temp;
+    }
+}
+
+/**
+ * @brief Orders channels by descending priority, then ascending channel ID.
+ * * The tie-break makes the order total, so qsort gives the same result on
+ * every C library even though it is not a stable sort.
+ */
+static inline int compareChannels(const void* a, const void* b) {
+    const ChannelInfo* channelA = (const ChannelInfo*)a;
+    const ChannelInfo* channelB = (const ChannelInfo*)b;
+    if (channelA->priority != channelB->priority) {
+        return channelB->priority - channelA->priority; // Sort in descending order
+    }
+    return channelA->channelId - channelB->channelId;
+}
+
+/**
+ * @brief Shuffles voice channels 1..voiceChannels and assigns random priorities.
+ * * 35% (rounded up) get low priority 1-2, the rest high priority 3-5.
+ * @param rngState Generator state advanced by channelRand().
+ */
+static inline void generateChannelsWithPriority(int voiceChannels, ChannelInfo* channels, unsigned int* rngState) {
+    for (int i = 0; i < voiceChannels; i++) {
+        channels[i].channelId = i + 1;
+    }
+
+    shuffleChannels(channels, voiceChannels, rngState);
+
+    int lowPriorityCount = (voiceChannels * 35 + 99) / 100; // Integer ceiling for 35%
+
+    // Assign low priority channels (priority 1-2)
+    for (int i = 0; i < lowPriorityCount; i++) {
+        channels[i].priority = (channelRand(rngState) % 2) + 1;
+    }
+
+    // Assign high priority channels (priority 3-5)
+    for (int i = lowPriorityCount; i < voiceChannels; i++) {
+        channels[i].priority = (channelRand(rngState) % 3) + 3;
+    }
+}
+
+/**
+ * @brief Priority-based round-robin allocation of voice channels to cell demand.
+ * * Sorts channels by priority (highest first), then fills column by column,
+ * skipping cells whose demand is already met.
+ * @param matrix Zeroed buffer of clusterSize * maxCols ints; demand beyond
+ * maxCols columns is left unserved.
+ * @return The number of voice channels allocated.
+ */
+static inline int dynamicAllocateTraffic(int clusterSize, ChannelInfo* channels, int voiceChannels,
+                                         const int* trafficDemand, int* matrix, int maxCols) {
+    qsort(channels, voiceChannels, sizeof(ChannelInfo), compareChannels);
+
+    int channelIndex = 0;
+    for (int col = 0; col < maxCols && channelIndex < voiceChannels; col++) {
+        for (int cell = 0; cell < clusterSize && channelIndex < voiceChannels; cell++) {
+            if (col < trafficDemand[cell]) {
+                matrix[(size_t)cell * maxCols + col] = channels[channelIndex].channelId;
+                channelIndex++;
+            }
+        }
+    }
+    return channelIndex;
+}
+
+#endif /* CHANNEL_ENGINE_H */
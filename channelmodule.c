@@ -0,0 +1,362 @@
+/*
+ * Python extension exposing the channel assignment engine (channel_engine.h).
+ *
+ * Build with:  pip install .   (or: python setup.py build_ext --inplace)
+ * pyproject.toml makes pip fetch NumPy's headers in its isolated build.
+ *
+ * Every returned matrix is a NumPy int32 array that takes ownership of the
+ * buffer the engine filled, so no data is copied on the way back to Python.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+#include <limits.h>
+#include <time.h>
+#include "channel_engine.h"
+
+// Upper bound on total_channels, so every matrix comfortably fits in memory and int
+#define MAX_TOTAL_CHANNELS 1000000
+
+static void freeCapsuleBuffer(PyObject* capsule) {
+    free(PyCapsule_GetPointer(capsule, NULL));
+}
+
+/**
+ * @brief Wraps a malloc'd int buffer in a 2D NumPy array without copying.
+ * * On success the array owns the buffer; on failure the buffer is freed.
+ */
+static PyObject* wrapIntMatrix(int* data, npy_intp rows, npy_intp cols) {
+    npy_intp dims[2] = { rows, cols };
+    PyObject* array = PyArray_SimpleNewFromData(2, dims, NPY_INT, data);
+    if (array == NULL) {
+        free(data);
+        return NULL;
+    }
+    PyObject* capsule = PyCapsule_New(data, NULL, freeCapsuleBuffer);
+    if (capsule == NULL) {
+        Py_DECREF(array);
+        free(data);
+        return NULL;
+    }
+    // PyArray_SetBaseObject steals the capsule reference, even on failure
+    if (PyArray_SetBaseObject((PyArrayObject*)array, capsule) < 0) {
+        Py_DECREF(array);
+        return NULL;
+    }
+    return array;
+}
+
+static int* allocMatrix(int rows, int cols) {
+    // Always allocate at least one int so an empty matrix still has a buffer to own
+    size_t count = (size_t)rows * cols;
+    int* matrix = (int*)calloc(count > 0 ? count : 1, sizeof(int));
+    if (matrix == NULL) {
+        PyErr_NoMemory();
+    }
+    return matrix;
+}
+
+PyDoc_STRVAR(fixed_assign_doc,
+"fixed_assign(total_channels, cluster_size, control_percentage)\n"
+"--\n\n"
+"Fixed channel assignment, as in fixed_channel.c.\n\n"
+"total_channels is at most 1000000 and control_percentage is a fraction\n"
+"in [0, 1]. There are\n"
+"max(ceil(total_channels * control_percentage), cluster_size) control\n"
+"channels, so every cell gets at least one. Channels are dealt round-robin\n"
+"across cells: control channels first, numbered from 1, then traffic\n"
+"channels. Returns (control_matrix, traffic_matrix), int32 arrays of shape\n"
+"(cluster_size, n) where row i holds cell i + 1 and unused slots are 0.");
+
+static PyObject* channel_fixed_assign(PyObject* self, PyObject* args) {
+    int totalChannels;
+    int clusterSize;
+    double controlChannelPercentage;
+
+    if (!PyArg_ParseTuple(args, "iid:fixed_assign", &totalChannels, &clusterSize, &controlChannelPercentage)) {
+        return NULL;
+    }
+    if (totalChannels <= 0 || totalChannels > MAX_TOTAL_CHANNELS) {
+        return PyErr_Format(PyExc_ValueError, "total_channels must be between 1 and %d, got %d",
+                            MAX_TOTAL_CHANNELS, totalChannels);
+    }
+    if (clusterSize <= 0) {
+        return PyErr_Format(PyExc_ValueError, "cluster_size must be positive, got %d", clusterSize);
+    }
+    if (!(controlChannelPercentage >= 0.0 && controlChannelPercentage <= 1.0)) {
+        PyErr_SetString(PyExc_ValueError, "control_percentage must be between 0 and 1");
+        return NULL;
+    }
+
+    int controlChannelsCount = fixedControlChannelCount(totalChannels, clusterSize, controlChannelPercentage);
+    if (controlChannelsCount > totalChannels) {
+        return PyErr_Format(PyExc_ValueError, "%d control channels (at least one per cell) exceed total_channels %d",
+                            controlChannelsCount, totalChannels);
+    }
+    int trafficChannelsCount = totalChannels - controlChannelsCount;
+    int controlMatrixCols = channelMatrixCols(controlChannelsCount, clusterSize);
+    int trafficMatrixCols = channelMatrixCols(trafficChannelsCount, clusterSize);
+
+    int* controlMatrix = allocMatrix(clusterSize, controlMatrixCols);
+    if (controlMatrix == NULL) {
+        return NULL;
+    }
+    int* trafficMatrix = allocMatrix(clusterSize, trafficMatrixCols);
+    if (trafficMatrix == NULL) {
+        free(controlMatrix);
+        return NULL;
+    }
+
+    fixedAssignChannels(1, controlChannelsCount, clusterSize, controlMatrix, controlMatrixCols);
+    fixedAssignChannels(controlChannelsCount + 1, trafficChannelsCount, clusterSize, trafficMatrix, trafficMatrixCols);
+
+    PyObject* control = wrapIntMatrix(controlMatrix, clusterSize, controlMatrixCols);
+    if (control == NULL) {
+        free(trafficMatrix);
+        return NULL;
+    }
+    PyObject* traffic = wrapIntMatrix(trafficMatrix, clusterSize, trafficMatrixCols);
+    if (traffic == NULL) {
+        Py_DECREF(control);
+        return NULL;
+    }
+    return Py_BuildValue("(NN)", control, traffic);
+}
+
+/**
+ * @brief Checks one demand value and stores it, or sets ValueError.
+ */
+static int storeDemand(int* trafficDemand, Py_ssize_t i, long long value, int overflow) {
+    if (overflow || value < 0 || value > INT_MAX) {
+        PyErr_Format(PyExc_ValueError, "traffic_demand[%zd] is out of range (0 to %d)", i, INT_MAX);
+        return -1;
+    }
+    trafficDemand[i] = (int)value;
+    return 0;
+}
+
+/**
+ * @brief Copies integer NumPy array elements into trafficDemand.
+ * * Signed and unsigned dtypes are widened separately so no value is cast
+ * out of range before it is checked.
+ */
+static int readDemandArray(PyArrayObject* array, int* trafficDemand) {
+    int isUnsigned = PyArray_ISUNSIGNED(array);
+    PyArrayObject* values = (PyArrayObject*)PyArray_FROMANY((PyObject*)array, isUnsigned ? NPY_ULONGLONG : NPY_LONGLONG,
+                                                            1, 1, NPY_ARRAY_IN_ARRAY);
+    if (values == NULL) {
+        return -1;
+    }
+    int status = 0;
+    for (npy_intp i = 0; i < PyArray_DIM(values, 0) && status == 0; i++) {
+        if (isUnsigned) {
+            unsigned long long value = ((const unsigned long long*)PyArray_DATA(values))[i];
+            status = storeDemand(trafficDemand, i, value > INT_MAX ? 0 : (long long)value, value > INT_MAX);
+        } else {
+            status = storeDemand(trafficDemand, i, ((const long long*)PyArray_DATA(values))[i], 0);
+        }
+    }
+    Py_DECREF(values);
+    return status;
+}
+
+/**
+ * @brief Copies the items of a Python sequence into trafficDemand.
+ * * Items are converted one at a time, so arbitrarily large Python ints
+ * report a range error rather than turning into a float or object array.
+ */
+static int readDemandSequence(PyObject* items, int* trafficDemand) {
+    for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(items); i++) {
+        PyObject* item = PySequence_Fast_GET_ITEM(items, i);
+        if (PyBool_Check(item) || !PyIndex_Check(item)) {
+            PyErr_Format(PyExc_TypeError, "traffic_demand must contain integers, got %.100s at index %zd",
+                         Py_TYPE(item)->tp_name, i);
+            return -1;
+        }
+        PyObject* index = PyNumber_Index(item);
+        if (index == NULL) {
+            return -1;
+        }
+        int overflow;
+        long long value = PyLong_AsLongLongAndOverflow(index, &overflow);
+        Py_DECREF(index);
+        if (storeDemand(trafficDemand, i, value, overflow) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Copies a 1D integer sequence of non-negative demands into a malloc'd int array.
+ * * Non-integer input raises TypeError and values outside [0, INT_MAX] raise
+ * ValueError. Sets a Python exception and returns NULL on any invalid input.
+ */
+static int* parseTrafficDemand(PyObject* demandObj, int* clusterSize) {
+    PyObject* items = NULL;
+    Py_ssize_t cells;
+
+    if (PyArray_Check(demandObj)) {
+        PyArrayObject* array = (PyArrayObject*)demandObj;
+        if (PyArray_NDIM(array) != 1) {
+            PyErr_SetString(PyExc_ValueError, "traffic_demand must be a non-empty 1-D sequence");
+            return NULL;
+        }
+        if (!PyArray_ISINTEGER(array)) {
+            PyErr_Format(PyExc_TypeError, "traffic_demand must contain integers, got dtype %R", (PyObject*)PyArray_DESCR(array));
+            return NULL;
+        }
+        cells = PyArray_DIM(array, 0);
+    } else {
+        items = PySequence_Fast(demandObj, "traffic_demand must be a non-empty 1-D sequence");
+        if (items == NULL) {
+            return NULL;
+        }
+        cells = PySequence_Fast_GET_SIZE(items);
+    }
+    if (cells == 0 || cells > INT_MAX) {
+        Py_XDECREF(items);
+        PyErr_SetString(PyExc_ValueError, "traffic_demand must be a non-empty 1-D sequence");
+        return NULL;
+    }
+
+    int* trafficDemand = (int*)malloc(cells * sizeof(int));
+    if (trafficDemand == NULL) {
+        Py_XDECREF(items);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    int status = items ? readDemandSequence(items, trafficDemand) : readDemandArray((PyArrayObject*)demandObj, trafficDemand);
+    Py_XDECREF(items);
+    if (status < 0) {
+        free(trafficDemand);
+        return NULL;
+    }
+    *clusterSize = (int)cells;
+    return trafficDemand;
+}
+
+// Generator state for dynamic_assign; private to this module, see channelRand()
+static unsigned int rngState;
+
+PyDoc_STRVAR(dynamic_assign_doc,
+"dynamic_assign(total_channels, traffic_demand, seed=None)\n"
+"--\n\n"
+"Priority-based dynamic channel assignment, as in dynamic_channel.c.\n\n"
+"total_channels is at most 1000000. traffic_demand is a 1-D sequence of\n"
+"non-negative integer channel demands, one per cell; its length is the\n"
+"cluster size. Non-integer demand raises TypeError and demand above\n"
+"2**31 - 1 raises ValueError. 10% of the channels\n"
+"(rounded up) are control channels, split into contiguous blocks per cell.\n"
+"Voice channels are shuffled, given priorities and dealt highest priority\n"
+"first.\n\n"
+"Randomness comes from a generator private to this module, seeded from the\n"
+"clock on import; the C library rand() stream is never touched. If seed is\n"
+"given that generator is reseeded first. Ties in priority are broken by\n"
+"channel ID, so a seeded result is the same on every platform.\n\n"
+"Returns (control_matrix, traffic_matrix, channels): the two int32 matrices\n"
+"have one row per cell with unused slots 0. The traffic matrix has\n"
+"min(max(traffic_demand), voice_channels) columns, since no cell can get\n"
+"more channels than exist. channels is an int32 array of shape\n"
+"(voice_channels, 2) holding (channel_id, priority) in allocation order:\n"
+"descending priority, then ascending channel ID.");
+
+static PyObject* channel_dynamic_assign(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = { "total_channels", "traffic_demand", "seed", NULL };
+    int totalChannels;
+    PyObject* demandObj;
+    PyObject* seedObj = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "iO|O:dynamic_assign", kwlist, &totalChannels, &demandObj, &seedObj)) {
+        return NULL;
+    }
+    if (totalChannels <= 0 || totalChannels > MAX_TOTAL_CHANNELS) {
+        return PyErr_Format(PyExc_ValueError, "total_channels must be between 1 and %d, got %d",
+                            MAX_TOTAL_CHANNELS, totalChannels);
+    }
+    if (seedObj != Py_None) {
+        unsigned long seed = PyLong_AsUnsignedLongMask(seedObj);
+        if (PyErr_Occurred()) {
+            return NULL;
+        }
+        rngState = (unsigned int)seed;
+    }
+
+    int clusterSize;
+    int* trafficDemand = parseTrafficDemand(demandObj, &clusterSize);
+    if (trafficDemand == NULL) {
+        return NULL;
+    }
+    int controlChannels = (totalChannels + 9) / 10; // Integer ceiling division for 10%
+    int voiceChannels = totalChannels - controlChannels;
+
+    // No cell can receive more than voiceChannels channels, so wider columns would only waste memory
+    int maxCols = 0;
+    for (int i = 0; i < clusterSize; i++) {
+        if (trafficDemand[i] > maxCols) {
+            maxCols = trafficDemand[i];
+        }
+    }
+    if (maxCols > voiceChannels) {
+        maxCols = voiceChannels;
+    }
+    int controlMatrixCols = channelMatrixCols(controlChannels, clusterSize);
+
+    int* controlMatrix = allocMatrix(clusterSize, controlMatrixCols);
+    int* trafficMatrix = controlMatrix ? allocMatrix(clusterSize, maxCols) : NULL;
+    // ChannelInfo is two packed ints, so the channel list is allocated and returned as an (n, 2) matrix
+    ChannelInfo* channels = trafficMatrix ? (ChannelInfo*)allocMatrix(voiceChannels, 2) : NULL;
+    if (channels == NULL) {
+        free(controlMatrix);
+        free(trafficMatrix);
+        free(trafficDemand);
+        return NULL;
+    }
+
+    dynamicControlLayout(clusterSize, controlChannels, controlMatrix, controlMatrixCols);
+    generateChannelsWithPriority(voiceChannels, channels, &rngState);
+    dynamicAllocateTraffic(clusterSize, channels, voiceChannels, trafficDemand, trafficMatrix, maxCols);
+    free(trafficDemand);
+
+    PyObject* control = wrapIntMatrix(controlMatrix, clusterSize, controlMatrixCols);
+    if (control == NULL) {
+        free(trafficMatrix);
+        free(channels);
+        return NULL;
+    }
+    PyObject* traffic = wrapIntMatrix(trafficMatrix, clusterSize, maxCols);
+    if (traffic == NULL) {
+        Py_DECREF(control);
+        free(channels);
+        return NULL;
+    }
+    PyObject* priorities = wrapIntMatrix((int*)channels, voiceChannels, 2);
+    if (priorities == NULL) {
+        Py_DECREF(control);
+        Py_DECREF(traffic);
+        return NULL;
+    }
+    return Py_BuildValue("(NNN)", control, traffic, priorities);
+}
+
+static PyMethodDef channelMethods[] = {
+    { "fixed_assign", channel_fixed_assign, METH_VARARGS, fixed_assign_doc },
+    { "dynamic_assign", (PyCFunction)(void (*)(void))channel_dynamic_assign, METH_VARARGS | METH_KEYWORDS, dynamic_assign_doc },
+    { NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef channelModule = {
+    PyModuleDef_HEAD_INIT,
+    "channel_engine",
+    "Native fixed and dynamic channel assignment engines.",
+    -1,
+    channelMethods
+};
+
+PyMODINIT_FUNC PyInit_channel_engine(void) {
+    import_array();
+    rngState = (unsigned int)time(NULL); // Initialize random seed, as dynamic_channel.c does
+    return PyModule_Create(&channelModule);
+}
@@ -1,41 +1,35 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <stdbool.h>
+#include "channel_engine.h"
 
 #define MAX_CHANNELS 100
 #define MAX_CLUSTER_SIZE 50
 
-typedef struct {
-    int channelId;
-    int priority;
-} ChannelInfo;
+// Random generator state for channel shuffling and priorities (see channelRand)
+static unsigned int rngState;
 
 // Function prototypes
 int getTotalChannels();
 int getValidClusterSize();
-bool isValidClusterSize(int N);
 void getTrafficDemand(int clusterSize, int* trafficDemand);
 void allocateChannels(int clusterSize, int controlChannels, int voiceChannels, int* trafficDemand);
 void displayControlChannelMatrix(int clusterSize, int controlChannels);
 void displayClusterFairness(int clusterSize, int* trafficDemand);
 void normalizeChannelDemand(int clusterSize, int* trafficDemand, int totalAvailableChannels);
 void displayVoiceChannelAllocation(int clusterSize, int voiceChannels, int* trafficDemand);
-void generateChannelsWithPriority(int voiceChannels, ChannelInfo* channels);
 void displayChannelPriorities(ChannelInfo* channels, int voiceChannels);
-void allocateTrafficChannels(int clusterSize, ChannelInfo* channels, int voiceChannels, int* trafficDemand, int** trafficMatrix, int maxCols);
-void displayTrafficMatrix(int** trafficMatrix, int clusterSize, int* trafficDemand);
-void displaySatisfactionMatrix(int clusterSize, int* trafficDemand, int** trafficMatrix);
-void displayFairnessDistribution(int clusterSize, ChannelInfo* channels, int voiceChannels, int* trafficDemand, int** trafficMatrix, int maxCols);
-void shuffleArray(int* array, int size);
-int compareChannels(const void* a, const void* b);
+void allocateTrafficChannels(int clusterSize, ChannelInfo* channels, int voiceChannels, int* trafficDemand, int* trafficMatrix, int maxCols);
+void displayTrafficMatrix(int* trafficMatrix, int clusterSize, int* trafficDemand, int maxCols);
+void displaySatisfactionMatrix(int clusterSize, int* trafficDemand, int* trafficMatrix, int maxCols);
+void displayFairnessDistribution(int clusterSize, ChannelInfo* channels, int voiceChannels, int* trafficDemand, int* trafficMatrix, int maxCols);
 int compareInts(const void* a, const void* b);
 int findMax(int* array, int size);
 int sumArray(int* array, int size);
 int countAllocatedChannels(int* row, int maxCols);
 
 int main() {
-    srand(time(NULL)); // Initialize random seed
+    rngState = (unsigned int)time(NULL); // Initialize random seed
     
     printf("=== Cellular Channel Allocation System ===\n\n");
     
@@ -103,23 +97,10 @@ int getValidClusterSize() {
             printf("Invalid cluster size. Valid cluster sizes follow the pattern N = i² + j² + i*j\n");
             printf("Common valid sizes: 1, 3, 4, 7, 9, 12, 13, 16, 19, 21, 25, 27, 28, 31...\n");
         }
-    } while (true);
+    } while (1);
     return clusterSize;
 }
 
-bool isValidClusterSize(int N) {
-    if (N <= 0) return false;
-    
-    for (int i = 0; i * i <= N; i++) {
-        for (int j = 0; j * j <= N; j++) {
-            if (i * i + j * j + i * j == N) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 void getTrafficDemand(int clusterSize, int* trafficDemand) {
     printf("\nEnter traffic channel demand for each cell:\n");
     for (int i = 0; i < clusterSize; i++) {
@@ -167,33 +148,16 @@ void displayControlChannelMatrix(int clusterSize, int controlChannels) {
     
     int baseChannelsPerCell = controlChannels / clusterSize;
     int extraChannels = controlChannels % clusterSize;
+    int maxCols = channelMatrixCols(controlChannels, clusterSize);
     
     // Create control channel matrix
-    int** controlMatrix = (int**)malloc(clusterSize * sizeof(int*));
+    int* controlMatrix = (int*)calloc((size_t)clusterSize * maxCols, sizeof(int));
     if (controlMatrix == NULL) {
         printf("Memory allocation failed!\n");
         return;
     }
     
-    int channelId = 1;
-    for (int i = 0; i < clusterSize; i++) {
-        int channelsForCell = baseChannelsPerCell + (i < extraChannels ? 1 : 0);
-        controlMatrix[i] = (int*)calloc(channelsForCell, sizeof(int));
-        if (controlMatrix[i] == NULL) {
-            printf("Memory allocation failed!\n");
-            // Free previously allocated memory
-            for (int j = 0; j < i; j++) {
-                free(controlMatrix[j]);
-            }
-            free(controlMatrix);
-            return;
-        }
-        
-        // Assign channel IDs
-        for (int j = 0; j < channelsForCell; j++) {
-            controlMatrix[i][j] = channelId++;
-        }
-    }
+    dynamicControlLayout(clusterSize, controlChannels, controlMatrix, maxCols);
     
     // Display the matrix
     printf("Control Channel Assignment Matrix:\n");
@@ -202,15 +166,12 @@ void displayControlChannelMatrix(int clusterSize, int controlChannels) {
         printf("Cell %2d: [", i + 1);
         for (int j = 0; j < channelsForCell; j++) {
             if (j > 0) printf(", ");
-            printf("%2d", controlMatrix[i][j]);
+            printf("%2d", controlMatrix[(size_t)i * maxCols + j]);
         }
         printf("]\n");
     }
     
     // Free allocated memory
-    for (int i = 0; i < clusterSize; i++) {
-        free(controlMatrix[i]);
-    }
     free(controlMatrix);
 }
 
@@ -247,7 +208,7 @@ void displayVoiceChannelAllocation(int clusterSize, int voiceChannels, int* traf
     }
     
     ChannelInfo channels[MAX_CHANNELS];
-    generateChannelsWithPriority(voiceChannels, channels);
+    generateChannelsWithPriority(voiceChannels, channels, &rngState);
     displayChannelPriorities(channels, voiceChannels);
     
     int maxCols = findMax(trafficDemand, clusterSize);
@@ -256,67 +217,27 @@ void displayVoiceChannelAllocation(int clusterSize, int voiceChannels, int* traf
         return;
     }
     
-    // Allocate memory for traffic matrix
-    int** trafficMatrix = (int**)malloc(clusterSize * sizeof(int*));
+    // Allocate memory for the row-major traffic matrix, one row per cell
+    int* trafficMatrix = (int*)calloc((size_t)clusterSize * maxCols, sizeof(int));
     if (trafficMatrix == NULL) {
         printf("Memory allocation failed!\n");
         return;
     }
     
-    for (int i = 0; i < clusterSize; i++) {
-        trafficMatrix[i] = (int*)calloc(maxCols, sizeof(int));
-        if (trafficMatrix[i] == NULL) {
-            printf("Memory allocation failed!\n");
-            // Free previously allocated memory
-            for (int j = 0; j < i; j++) {
-                free(trafficMatrix[j]);
-            }
-            free(trafficMatrix);
-            return;
-        }
-    }
-    
     allocateTrafficChannels(clusterSize, channels, voiceChannels, trafficDemand, trafficMatrix, maxCols);
     
     // Display fairness distribution with high/low priority breakdown
     displayFairnessDistribution(clusterSize, channels, voiceChannels, trafficDemand, trafficMatrix, maxCols);
     
-    displayTrafficMatrix(trafficMatrix, clusterSize, trafficDemand);
+    displayTrafficMatrix(trafficMatrix, clusterSize, trafficDemand, maxCols);
     
     // Display additional metrics
-    displaySatisfactionMatrix(clusterSize, trafficDemand, trafficMatrix);
+    displaySatisfactionMatrix(clusterSize, trafficDemand, trafficMatrix, maxCols);
     
     // Free allocated memory
-    for (int i = 0; i < clusterSize; i++) {
-        free(trafficMatrix[i]);
-    }
     free(trafficMatrix);
 }
 
-void generateChannelsWithPriority(int voiceChannels, ChannelInfo* channels) {
-    int channelNumbers[MAX_CHANNELS];
-    for (int i = 0; i < voiceChannels; i++) {
-        channelNumbers[i] = i + 1;
-    }
-    
-    shuffleArray(channelNumbers, voiceChannels);
-    
-    int lowPriorityCount = (voiceChannels * 35 + 99) / 100; // Integer ceiling for 35%
-    int highPriorityCount = voiceChannels - lowPriorityCount;
-    
-    // Assign low priority channels (priority 1-2)
-    for (int i = 0; i < lowPriorityCount; i++) {
-        channels[i].channelId = channelNumbers[i];
-        channels[i].priority = (rand() % 2) + 1;
-    }
-    
-    // Assign high priority channels (priority 3-5)
-    for (int i = lowPriorityCount; i < voiceChannels; i++) {
-        channels[i].channelId = channelNumbers[i];
-        channels[i].priority = (rand() % 3) + 3;
-    }
-}
-
 void displayChannelPriorities(ChannelInfo* channels, int voiceChannels) {
     int lowPriority[MAX_CHANNELS], highPriority[MAX_CHANNELS];
     int lowCount = 0, highCount = 0;
@@ -353,27 +274,17 @@ void displayChannelPriorities(ChannelInfo* channels, int voiceChannels) {
     }
 }
 
-void allocateTrafficChannels(int clusterSize, ChannelInfo* channels, int voiceChannels, int* trafficDemand, int** trafficMatrix, int maxCols) {
-    // Sort channels by priority (highest first)
-    qsort(channels, voiceChannels, sizeof(ChannelInfo), compareChannels);
-    
+void allocateTrafficChannels(int clusterSize, ChannelInfo* channels, int voiceChannels, int* trafficDemand, int* trafficMatrix, int maxCols) {
     printf("\n=== Fairness Distribution Process ===\n");
     printf("Using priority-based round-robin allocation\n");
     
-    int channelIndex = 0;
-    for (int col = 0; col < maxCols && channelIndex < voiceChannels; col++) {
-        for (int cell = 0; cell < clusterSize && channelIndex < voiceChannels; cell++) {
-            if (col < trafficDemand[cell]) {
-                trafficMatrix[cell][col] = channels[channelIndex].channelId;
-                channelIndex++;
-            }
-        }
-    }
+    // Sort channels by priority (highest first) and fill cells column by column
+    int allocated = dynamicAllocateTraffic(clusterSize, channels, voiceChannels, trafficDemand, trafficMatrix, maxCols);
     
-    printf("Allocated %d out of %d available voice channels\n", channelIndex, voiceChannels);
+    printf("Allocated %d out of %d available voice channels\n", allocated, voiceChannels);
 }
 
-void displayFairnessDistribution(int clusterSize, ChannelInfo* channels, int voiceChannels, int* trafficDemand, int** trafficMatrix, int maxCols) {
+void displayFairnessDistribution(int clusterSize, ChannelInfo* channels, int voiceChannels, int* trafficDemand, int* trafficMatrix, int maxCols) {
     printf("\n=== Fairness Distribution ===\n");
     printf("High and Low Priority Channel Allocation per Cluster:\n");
     printf("%-6s %-8s %-12s %-12s %-10s\n", 
@@ -396,9 +307,9 @@ void displayFairnessDistribution(int clusterSize, ChannelInfo* channels, int voi
         int totalAllocated = 0;
         
         for (int col = 0; col < trafficDemand[cell]; col++) {
-            if (trafficMatrix[cell][col] != 0) {
+            if (trafficMatrix[(size_t)cell * maxCols + col] != 0) {
                 totalAllocated++;
-                int priority = channelPriorityMap[trafficMatrix[cell][col]];
+                int priority = channelPriorityMap[trafficMatrix[(size_t)cell * maxCols + col]];
                 if (priority <= 2) {
                     lowPriorityCount++;
                 } else {
@@ -420,18 +331,18 @@ void displayFairnessDistribution(int clusterSize, ChannelInfo* channels, int voi
            "Total", totalHighPriority + totalLowPriority, totalHighPriority, totalLowPriority, totalDemand);
 }
 
-void displayTrafficMatrix(int** trafficMatrix, int clusterSize, int* trafficDemand) {
+void displayTrafficMatrix(int* trafficMatrix, int clusterSize, int* trafficDemand, int maxCols) {
     printf("\n=== Traffic Channel Allocation Matrix ===\n");
     printf("(Channels allocated to each cell)\n");
     
     for (int row = 0; row < clusterSize; row++) {
         printf("Cell %2d: [", row + 1);
-        bool first = true;
+        int first = 1;
         for (int col = 0; col < trafficDemand[row]; col++) {
-            if (trafficMatrix[row][col] != 0) {
+            if (trafficMatrix[(size_t)row * maxCols + col] != 0) {
                 if (!first) printf(", ");
-                printf("%2d", trafficMatrix[row][col]);
-                first = false;
+                printf("%2d", trafficMatrix[(size_t)row * maxCols + col]);
+                first = 0;
             }
         }
         printf("]\n");
@@ -439,21 +350,6 @@ void displayTrafficMatrix(int** trafficMatrix, int clusterSize, int* trafficDema
 }
 
 // Utility functions
-void shuffleArray(int* array, int size) {
-    for (int i = size - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        int temp = array[i];
-        array[i] = array[j];
-        array[j] = temp;
-    }
-}
-
-int compareChannels(const void* a, const void* b) {
-    ChannelInfo* channelA = (ChannelInfo*)a;
-    ChannelInfo* channelB = (ChannelInfo*)b;
-    return channelB->priority - channelA->priority; // Sort in descending order
-}
-
 int compareInts(const void* a, const void* b) {
     return (*(int*)a - *(int*)b); // Sort in ascending order
 }
@@ -487,7 +383,7 @@ int countAllocatedChannels(int* row, int maxCols) {
     return count;
 }
 
-void displaySatisfactionMatrix(int clusterSize, int* trafficDemand, int** trafficMatrix) {
+void displaySatisfactionMatrix(int clusterSize, int* trafficDemand, int* trafficMatrix, int maxCols) {
     printf("\n=== Performance Analysis ===\n");
     printf("Demand vs Allocation Summary:\n");
     printf("%-6s %-8s %-10s %-15s %-8s %-10s\n", 
@@ -497,7 +393,7 @@ void displaySatisfactionMatrix(int clusterSize, int* trafficDemand, int** traffi
     int totalDemand = 0, totalAllocated = 0, totalBlocked = 0;
     
     for (int i = 0; i < clusterSize; i++) {
-        int allocated = countAllocatedChannels(trafficMatrix[i], trafficDemand[i]);
+        int allocated = countAllocatedChannels(trafficMatrix + (size_t)i * maxCols, trafficDemand[i]);
         int blocked = trafficDemand[i] - allocated;
         double satisfaction = (trafficDemand[i] > 0) ? (allocated * 100.0 / trafficDemand[i]) : 100.0;
         double blockingPercentage = (trafficDemand[i] > 0) ? (blocked * 100.0 / trafficDemand[i]) : 0.0;
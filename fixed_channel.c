@@ -1,26 +1,25 @@
 #include <stdio.h> 
 #include <stdlib.h> 
-#include <string.h> 
-#include <math.h> 
+#include "channel_engine.h" 
 #define MIN_CHANNELS 50 
 #define MAX_CHANNELS 100 
 #define MIN_CONTROL_PERCENTAGE 0.10 
 #define MAX_CONTROL_PERCENTAGE 0.15 
 /** 
-* @brief Prints a dynamically allocated 2D matrix. 
+* @brief Prints a dynamically allocated row-major 2D matrix. 
 * * @param rows The number of rows in the matrix. 
 * @param cols The number of columns in the matrix. 
-* @param matrix A pointer to the 2D array. 
+* @param matrix A pointer to the flat rows * cols array. 
 * @param title A string containing the title for the matrix. 
  */ 
-void printMatrix(int rows, int cols, int** matrix, const char* title) { 
+void printMatrix(int rows, int cols, const int* matrix, const char* title) { 
     printf("\n%s is:\n", title); 
     for (int i = 0; i < rows; i++) { 
         printf("["); 
         for (int j = 0; j < cols; j++) { 
             // Check if the element is not zero to avoid printing unused slots 
-            if (matrix[i][j] != 0) { 
-                printf("%d ", matrix[i][j]); 
+            if (matrix[i * cols + j] != 0) { 
+                printf("%d ", matrix[i * cols + j]); 
             } 
         } 
         printf("]\n"); 
@@ -67,89 +66,41 @@ MIN_CONTROL_PERCENTAGE, MAX_CONTROL_PERCENTAGE);
         return 1; 
     } 
  
-    // Calculate the number of control and traffic channels based on the user-provided percentage 
-    controlChannelsCount = (int)ceil(totalChannels * controlChannelPercentage); 
- 
-    // Ensure there is at least one control channel per cell in the cluster 
-    if (controlChannelsCount < clusterSize) { 
-        controlChannelsCount = clusterSize; 
-    } 
+    // Calculate the number of control and traffic channels based on the user-provided percentage, 
+    // ensuring there is at least one control channel per cell in the cluster 
+    controlChannelsCount = fixedControlChannelCount(totalChannels, clusterSize, controlChannelPercentage); 
     trafficChannelsCount = totalChannels - controlChannelsCount; 
  
     printf("\nOutput for case: Total channels = %d and cluster size = %d\n", totalChannels, clusterSize); 
  
-    // Calculate matrix dimensions for control channels 
-    int controlMatrixRows = clusterSize; 
-    // Use ceiling division to determine the number of columns needed 
-    int controlMatrixCols = (int)ceil((double)controlChannelsCount / clusterSize); 
+    // Calculate matrix dimensions, using ceiling division for the number of columns 
+    int controlMatrixCols = channelMatrixCols(controlChannelsCount, clusterSize); 
+    int trafficMatrixCols = channelMatrixCols(trafficChannelsCount, clusterSize); 
  
-    // Dynamically allocate memory for the control channel matrix 
-    int** controlMatrix = (int**)malloc(controlMatrixRows * sizeof(int*)); 
+    // Allocate zero-initialised row-major matrices, one row per cell 
+    int* controlMatrix = (int*)calloc((size_t)clusterSize * controlMatrixCols, sizeof(int)); 
     if (controlMatrix == NULL) { 
         printf("Memory allocation failed for control matrix.\n"); 
         return 1; 
     } 
-    for (int i = 0; i < controlMatrixRows; i++) { 
-        controlMatrix[i] = (int*)malloc(controlMatrixCols * sizeof(int)); 
-        if (controlMatrix[i] == NULL) { 
-            printf("Memory allocation failed for control matrix row %d.\n", i); 
-            return 1; 
-        } 
-        // Initialize the memory to zero 
-        memset(controlMatrix[i], 0, controlMatrixCols * sizeof(int)); 
-    } 
- 
-    // Calculate matrix dimensions for traffic channels 
-    int trafficMatrixRows = clusterSize; 
-    int trafficMatrixCols = (int)ceil((double)trafficChannelsCount / clusterSize); 
- 
-    // Dynamically allocate memory for the traffic channel matrix 
-    int** trafficMatrix = (int**)malloc(trafficMatrixRows * sizeof(int*)); 
+    int* trafficMatrix = (int*)calloc((size_t)clusterSize * trafficMatrixCols, sizeof(int)); 
     if (trafficMatrix == NULL) { 
         printf("Memory allocation failed for traffic matrix.\n"); 
+        free(controlMatrix); 
         return 1; 
     } 
-    for (int i = 0; i < trafficMatrixRows; i++) { 
-        trafficMatrix[i] = (int*)malloc(trafficMatrixCols * sizeof(int)); 
-        if (trafficMatrix[i] == NULL) { 
-            printf("Memory allocation failed for traffic matrix row %d.\n", i); 
-            return 1; 
-        } 
-        // Initialize the memory to zero 
-        memset(trafficMatrix[i], 0, trafficMatrixCols * sizeof(int)); 
-    } 
  
-    // Distribute control channels in a round-robin fashion across cells (rows) 
-    for (int i = 0; i < controlChannelsCount; i++) { 
-        int row = i % clusterSize; 
-        int col = i / clusterSize; 
-        if (row < controlMatrixRows && col < controlMatrixCols) { 
-            controlMatrix[row][col] = i + 1; // Assign channel numbers from 1 
-        } 
-    } 
- 
-    // Distribute traffic channels sequentially after the control channels 
-    for (int i = 0; i < trafficChannelsCount; i++) { 
-        int row = i % clusterSize; 
-        int col = i / clusterSize; 
-        if (row < trafficMatrixRows && col < trafficMatrixCols) { 
-            trafficMatrix[row][col] = controlChannelsCount + 1 + i; // Correctly start after the last control channel 
-        } 
-    } 
+    // Distribute control channels round-robin across cells, numbered from 1, 
+    // then traffic channels starting after the last control channel 
+    fixedAssignChannels(1, controlChannelsCount, clusterSize, controlMatrix, controlMatrixCols); 
+    fixedAssignChannels(controlChannelsCount + 1, trafficChannelsCount, clusterSize, trafficMatrix, trafficMatrixCols); 
  
     // Print the resulting matrices 
-    printMatrix(controlMatrixRows, controlMatrixCols, controlMatrix, "The control channel matrix"); 
-    printMatrix(trafficMatrixRows, trafficMatrixCols, trafficMatrix, "The traffic channel matrix"); 
+    printMatrix(clusterSize, controlMatrixCols, controlMatrix, "The control channel matrix"); 
+    printMatrix(clusterSize, trafficMatrixCols, trafficMatrix, "The traffic channel matrix"); 
  
     // Free the dynamically allocated memory to prevent memory leaks 
-    for (int i = 0; i < controlMatrixRows; i++) { 
-        free(controlMatrix[i]); 
-    } 
     free(controlMatrix); 
- 
-    for (int i = 0; i < trafficMatrixRows; i++) { 
-free(trafficMatrix[i]); 
-} 
-free(trafficMatrix); 
-return 0; 
+    free(trafficMatrix); 
+    return 0; 
 }
\ No newline at end of file
@@ -0,0 +1,17 @@
+import numpy
+from setuptools import Extension, setup
+
+setup(
+    name="channel_engine",
+    version="1.0",
+    description="Native fixed and dynamic channel assignment engines",
+    install_requires=["numpy"],
+    ext_modules=[
+        Extension(
+            "channel_engine",
+            sources=["channelmodule.c"],
+            include_dirs=[".", numpy.get_include()],
+            depends=["channel_engine.h"],
+        )
+    ],
+)
@@ -0,0 +1,239 @@
+"""Golden-output tests for the channel assignment engine.
+
+Run from the repository root after building the extension:
+
+    python setup.py build_ext --inplace
+    python -m unittest discover tests
+
+golden/fixed_channel.txt holds the output of fixed_channel.c for a grid of
+(total, cluster, percentage) inputs, and golden/dynamic_assign.json holds
+seeded dynamic_assign results. After an intended layout change, regenerate
+them with:
+
+    python tests/test_channel_engine.py --update
+"""
+import itertools
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+
+import numpy as np
+
+TESTS_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.dirname(TESTS_DIR)
+GOLDEN_DIR = os.path.join(TESTS_DIR, "golden")
+FIXED_GOLDEN = os.path.join(GOLDEN_DIR, "fixed_channel.txt")
+DYNAMIC_GOLDEN = os.path.join(GOLDEN_DIR, "dynamic_assign.json")
+
+sys.path.insert(0, REPO_DIR)
+import channel_engine
+
+# Inputs accepted by fixed_channel.c's prompts
+CLUSTER_SIZES = [7, 9, 13]
+PERCENTAGES = ["0.10", "0.11", "0.12", "0.13", "0.14", "0.15"]
+GOLDEN_TOTALS = [50, 51, 63, 75, 88, 99, 100]
+
+DYNAMIC_CASES = [
+    (60, [5, 3, 8, 2, 6, 4, 7], 1),
+    (75, [5, 10, 3, 8, 12, 0, 9], 42),
+    (100, [10, 10, 10, 10, 10, 10, 10, 10, 10], 2024),
+    (90, [20] * 13, 7),
+    (50, [4, 4, 4], 123),
+]
+
+CASE_HEADER = re.compile(r"^=== total=(\d+) cluster=(\d+) pct=([\d.]+) ===\n", re.MULTILINE)
+
+
+def compile_fixed_channel(build_dir):
+    """Builds fixed_channel.c into build_dir, or returns None without a C compiler."""
+    compiler = shutil.which("cc") or shutil.which("gcc")
+    if compiler is None:
+        return None
+    binary = os.path.join(build_dir, "fixed_channel")
+    subprocess.run([compiler, "-o", binary, os.path.join(REPO_DIR, "fixed_channel.c"), "-lm"],
+                   check=True, cwd=REPO_DIR)
+    return binary
+
+
+def run_fixed_channel(binary, total, cluster, pct):
+    result = subprocess.run([binary], input=f"{total}\n{cluster}\n{pct}\n",
+                            capture_output=True, text=True, check=True)
+    return result.stdout
+
+
+def parse_matrix(output, title):
+    """Extracts the rows printed by fixed_channel.c's printMatrix() for title."""
+    lines = output.split(f"\n{title} is:\n", 1)[1].split("\n")
+    rows = []
+    for line in lines:
+        if not line.startswith("["):
+            break
+        rows.append([int(value) for value in line.strip("[] ").split()])
+    return rows
+
+
+def program_matrices(output):
+    return (parse_matrix(output, "The control channel matrix"),
+            parse_matrix(output, "The traffic channel matrix"))
+
+
+def engine_rows(matrix):
+    return [row[row > 0].tolist() for row in matrix]
+
+
+def read_fixed_golden():
+    with open(FIXED_GOLDEN) as f:
+        text = f.read()
+    parts = CASE_HEADER.split(text)[1:]
+    return {(int(total), int(cluster), pct): output
+            for total, cluster, pct, output in zip(*[iter(parts)] * 4)}
+
+
+def dynamic_result(total, demand, seed):
+    control, traffic, channels = channel_engine.dynamic_assign(total, demand, seed=seed)
+    return {"total": total, "demand": demand, "seed": seed,
+            "control": control.tolist(), "traffic": traffic.tolist(), "channels": channels.tolist()}
+
+
+class FixedAssignTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.golden = read_fixed_golden()
+        cls.build_dir = tempfile.mkdtemp()
+        cls.binary = compile_fixed_channel(cls.build_dir)
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls.build_dir)
+
+    def test_golden_covers_grid(self):
+        expected = set(itertools.product(GOLDEN_TOTALS, CLUSTER_SIZES, PERCENTAGES))
+        self.assertEqual(set(self.golden), expected)
+
+    def test_program_matches_golden(self):
+        if self.binary is None:
+            self.skipTest("no C compiler available")
+        for (total, cluster, pct), output in self.golden.items():
+            with self.subTest(total=total, cluster=cluster, pct=pct):
+                self.assertEqual(run_fixed_channel(self.binary, total, cluster, pct), output)
+
+    def test_engine_matches_golden(self):
+        for (total, cluster, pct), output in self.golden.items():
+            with self.subTest(total=total, cluster=cluster, pct=pct):
+                control, traffic = channel_engine.fixed_assign(total, cluster, float(pct))
+                self.assertEqual((engine_rows(control), engine_rows(traffic)), program_matrices(output))
+
+    def test_engine_matches_program_for_all_prompt_inputs(self):
+        if self.binary is None:
+            self.skipTest("no C compiler available")
+        for total, cluster, pct in itertools.product(range(50, 101), CLUSTER_SIZES, PERCENTAGES):
+            with self.subTest(total=total, cluster=cluster, pct=pct):
+                output = run_fixed_channel(self.binary, total, cluster, pct)
+                control, traffic = channel_engine.fixed_assign(total, cluster, float(pct))
+                self.assertEqual((engine_rows(control), engine_rows(traffic)), program_matrices(output))
+
+    def test_rejects_invalid_input(self):
+        with self.assertRaises(ValueError):
+            channel_engine.fixed_assign(5, 7, 0.10)
+        with self.assertRaises(ValueError):
+            channel_engine.fixed_assign(75, 7, 1.5)
+        with self.assertRaises(ValueError):
+            channel_engine.fixed_assign(2**31 - 1, 5, 1.0)
+
+
+class DynamicAssignTest(unittest.TestCase):
+    def assert_valid_assignment(self, total, demand, control, traffic, channels):
+        """Checks the properties every dynamic_assign result must have, independent of the golden."""
+        control_channels = (total + 9) // 10
+        voice_channels = total - control_channels
+        self.assertEqual(sorted(control[control > 0].tolist()), list(range(1, control_channels + 1)))
+
+        # Every voice channel gets one priority, 35% (rounded up) of them low
+        ids, priorities = channels[:, 0], channels[:, 1]
+        self.assertEqual(sorted(ids.tolist()), list(range(1, voice_channels + 1)))
+        self.assertTrue(((priorities >= 1) & (priorities <= 5)).all())
+        self.assertEqual(np.count_nonzero(priorities <= 2), (voice_channels * 35 + 99) // 100)
+        order = list(zip((-priorities).tolist(), ids.tolist()))
+        self.assertEqual(order, sorted(order))
+
+        # Each voice channel is used at most once and no cell gets more than it asked for
+        used = traffic[traffic > 0].tolist()
+        self.assertEqual(len(used), len(set(used)))
+        self.assertLessEqual(set(used), set(range(1, voice_channels + 1)))
+        self.assertEqual(len(used), min(sum(demand), voice_channels))
+        for row, cell_demand in zip(traffic, demand):
+            self.assertLessEqual(np.count_nonzero(row), cell_demand)
+
+    def test_seeded_results_match_golden(self):
+        with open(DYNAMIC_GOLDEN) as f:
+            golden = json.load(f)
+        self.assertEqual(len(golden), len(DYNAMIC_CASES))
+        for case in golden:
+            with self.subTest(total=case["total"], demand=case["demand"], seed=case["seed"]):
+                self.assertEqual(dynamic_result(case["total"], case["demand"], case["seed"]), case)
+                self.assert_valid_assignment(case["total"], case["demand"],
+                                             *(np.array(case[key]) for key in ("control", "traffic", "channels")))
+
+    def test_random_inputs_are_valid(self):
+        rng = np.random.default_rng(0)
+        for seed in range(200):
+            total = int(rng.integers(1, 500))
+            demand = rng.integers(0, 30, size=int(rng.integers(1, 20))).tolist()
+            with self.subTest(total=total, demand=demand, seed=seed):
+                result = channel_engine.dynamic_assign(total, demand, seed=seed)
+                self.assert_valid_assignment(total, demand, *result)
+
+    def test_traffic_width_is_capped_by_voice_channels(self):
+        control, traffic, channels = channel_engine.dynamic_assign(100, [0, 0, 2**30], seed=1)
+        self.assertEqual(traffic.shape, (3, 90))
+        self.assertEqual(sorted(traffic[2].tolist()), list(range(1, 91)))
+
+    def test_rejects_non_integer_demand(self):
+        with self.assertRaises(TypeError):
+            channel_engine.dynamic_assign(60, [2.9, 1, 1])
+        with self.assertRaises(TypeError):
+            channel_engine.dynamic_assign(60, np.array([2.0, 1.0, 1.0]))
+
+    def test_accepts_any_integer_dtype(self):
+        expected = channel_engine.dynamic_assign(60, [1, 2], seed=5)
+        for dtype in (np.int8, np.uint8, np.int64, np.uint64):
+            with self.subTest(dtype=dtype):
+                result = channel_engine.dynamic_assign(60, np.array([1, 2], dtype=dtype), seed=5)
+                self.assertTrue(all((a == b).all() for a, b in zip(result, expected)))
+
+    def test_out_of_range_demand_raises_value_error(self):
+        for demand in ([-1], [2**31], [2**63], [1, 2**63], [2**64], np.array([2**63], dtype=np.uint64)):
+            with self.subTest(demand=demand):
+                with self.assertRaises(ValueError):
+                    channel_engine.dynamic_assign(60, demand)
+
+
+def update_goldens():
+    build_dir = tempfile.mkdtemp()
+    try:
+        binary = compile_fixed_channel(build_dir)
+        if binary is None:
+            sys.exit("a C compiler is needed to regenerate the fixed_channel.c golden")
+        with open(FIXED_GOLDEN, "w") as f:
+            for total, cluster, pct in itertools.product(GOLDEN_TOTALS, CLUSTER_SIZES, PERCENTAGES):
+                f.write(f"=== total={total} cluster={cluster} pct={pct} ===\n")
+                f.write(run_fixed_channel(binary, total, cluster, pct))
+    finally:
+        shutil.rmtree(build_dir)
+
+    with open(DYNAMIC_GOLDEN, "w") as f:
+        # One case per line keeps the golden diffable
+        cases = [json.dumps(dynamic_result(*case)) for case in DYNAMIC_CASES]
+        f.write("[\n" + ",\n".join(cases) + "\n]\n")
+
+
+if __name__ == "__main__":
+    if "--update" in sys.argv:
+        update_goldens()
+    else:
+        unittest.main()